@@ -0,0 +1,44 @@
+#!/bin/bash
+# Compares the single and double precision builds of the batch simulations.
+# Run both first with: ./make.sh run -O batch batch_float
+# For every logged column (errors and message sizes of every algorithm), prints its mean over all runs and times
+# in the double (output/) and float (output/float/) builds, followed by the throughput of both builds.
+
+# Prints the mean of every column in the given FCPP output files.
+means() {
+    awk '
+        /^#/ {
+            if (head) for (i = 2; i <= NF; ++i) name[i-1] = $i;
+            head = ($0 ~ /columns have the following meaning/);
+            next;
+        }
+        NF > 0 {
+            for (i = 1; i <= NF; ++i) if ($i == $i+0) { sum[i] += $i; cnt[i]++; }
+            if (NF > cols) cols = NF;
+        }
+        END {
+            for (i = 1; i <= cols; ++i) if (cnt[i] > 0 && name[i] != "time") print name[i], sum[i] / cnt[i];
+        }
+    ' "$@"
+}
+
+# Prints the value of a field in a throughput file.
+field() {
+    awk -v key="$2" '$1 == key { print $2 }' "$1" 2>/dev/null
+}
+
+shopt -s nullglob
+double=(output/batch*.txt)
+float=(output/float/batch*.txt)
+if [ ${#double[@]} -eq 0 -o ${#float[@]} -eq 0 ]; then
+    echo "missing outputs: run ./make.sh run -O batch batch_float first" >&2
+    exit 1
+fi
+
+printf "%-40s %16s %16s\n" "column" "double" "float"
+awk '
+    NR == FNR { d[$1] = $2; order[++n] = $1; next; }
+    { f[$1] = $2; }
+    END { for (i = 1; i <= n; ++i) printf "%-40s %16.6g %16.6g\n", order[i], d[order[i]], f[order[i]]; }
+' <(means "${double[@]}") <(means "${float[@]}")
+printf "%-40s %16s %16s\n" "rounds/sec" "$(field output/throughput.txt rounds/sec)" "$(field output/float/throughput.txt rounds/sec)"
@@ -15,7 +15,7 @@ namespace fcpp {
 namespace coordination {
 
 //! @brief Gradient descent minimising linearised least squares (equivalent to elastic forces towards measured distances).
-vec<2> gradient_descent(vec<2> pos, std::vector<tuple<vec<2>, real_t>> const& anchors, real_t alpha = 0.1) {
+inline vec<2> gradient_descent(vec<2> pos, std::vector<tuple<vec<2>, real_t>> const& anchors, real_t alpha = 0.1) {
     for (auto const& t : anchors) {
         vec<2> pos_stim = get<0>(t);
         real_t sensed_dist = get<1>(t);
@@ -23,7 +23,8 @@ vec<2> gradient_descent(vec<2> pos, std::vector<tuple<vec<2>, real_t>> const& an
         real_t delta = sensed_dist - pos_dist;
         vec<2> diff = pos - pos_stim;
         real_t length = norm(diff);
-        if (length > 1e-6) pos += (alpha * delta / length) * diff;
+        // directions shorter than the resolution of coordinates are noise (1e-6 in double, min_dist in single precision)
+        if (length > std::max(real_t(1e-6), multilateration_limits::min_dist)) pos += (alpha * delta / length) * diff;
     }
     return pos;
 }
@@ -52,6 +53,37 @@ FUN vec<2> ml_coop(ARGS, vec<2> init, bool is_anchor, field<real_t> nbr_dist){ C
 FUN_EXPORT ml_coop_t = export_list<vec<2>>;
 
 
+/**
+ * @brief Cooperative localization based on multilateration, tracking moving devices.
+ *
+ * Keeps a constant-velocity state updated as an alpha-beta filter: the position is predicted at round time,
+ * multilateration is warm-started from the prediction, and position and velocity are corrected
+ * by fractions alpha and beta of the residual between the multilateration and the prediction.
+ */
+FUN vec<2> ml_track(ARGS, vec<2> init, bool is_anchor, field<real_t> nbr_dist, real_t alpha, real_t beta){ CODE
+    return nbr(CALL, init, [&](field<vec<2>> nbr_pos) {
+        auto pos_dist_vec = list_hood(CALL, std::vector<tuple<vec<2>, real_t>>{}, make_tuple(nbr_pos, nbr_dist), tags::nothing{});
+        vec<2> pos = self(CALL, nbr_pos);
+        real_t dt = node.current_time() - node.previous_time();
+        if (not std::isfinite(dt)) dt = 0;
+        old(CALL, make_vec(0, 0), [&](vec<2> vel){
+            if (is_anchor) {
+                pos = node.position();
+                return vel;
+            }
+            vec<2> pred = pos + vel * dt;
+            vec<2> res = multilateration(pred, pos_dist_vec) - pred;
+            pos = pred + alpha * res;
+            if (dt > 0) vel += (beta / dt) * res;
+            return vel;
+        });
+        return pos;
+    });
+}
+//! @brief Export list for ml_track.
+FUN_EXPORT ml_track_t = export_list<vec<2>>;
+
+
 /**
  * @brief Cooperative localization based on weighted multilateration.
  *
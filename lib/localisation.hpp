@@ -8,6 +8,8 @@
 #ifndef LOCALISATION_H_
 #define LOCALISATION_H_
 
+#include <chrono>
+
 #include "lib/fcpp.hpp"
 #include "lib/dv.hpp"
 #include "lib/coop.hpp"
@@ -20,6 +22,27 @@ namespace fcpp {
 //! @brief The time at which part of the devices are dead.
 constexpr size_t bad_time = 50;
 
+//! @brief Fraction of the multilateration residual corrected in the position by the tracking filter.
+constexpr real_t track_alpha = 0.8;
+//! @brief Fraction of the multilateration residual (per second) corrected in the velocity by the tracking filter.
+constexpr real_t track_beta = 0.2;
+
+#ifdef LOCALISATION_LEAN
+//! @brief Type of the distance errors stored in nodes (narrow in the memory-lean configuration).
+using error_type = float;
+//! @brief Type of the message sizes stored in nodes (narrow in the memory-lean configuration).
+using msg_size_type = uint32_t;
+//! @brief Time for which messages are retained (short in the memory-lean configuration).
+constexpr size_t retain_time = 2;
+#else
+//! @brief Type of the distance errors stored in nodes.
+using error_type = real_t;
+//! @brief Type of the message sizes stored in nodes.
+using msg_size_type = size_t;
+//! @brief Time for which messages are retained.
+constexpr size_t retain_time = 5;
+#endif
+
 //! @brief Dummy ordering between positions (allows positions to be used as secondary keys in ordered tuples).
 template <size_t n>
 bool operator<(vec<n> const&, vec<n> const&) {
@@ -41,8 +64,22 @@ namespace tags {
     struct random {};
     //! @brief Long-range device speed to consider in the simulation.
     struct speed {};
-    //! @brief The name of the algorithm to be displayed graphically.
+    //! @brief Number of (non-anchor) devices in the simulation.
+    struct devices {};
+    //! @brief Number of anchors in the simulation in addition to the perimeter ones.
+    struct extra_anchors {};
+    //! @brief Side of the square area where devices move.
+    struct side {};
+    //! @brief The index of the algorithm to be displayed graphically (in algorithm_tags).
     struct display {};
+    //! @brief Simulated time until which the simulation runs as fast as possible.
+    struct fast_forward {};
+    //! @brief Bytes used on the heap by the node storage (debug string).
+    struct heap_bytes {};
+    //! @brief Number of rounds performed in the network (for throughput measures).
+    struct rounds {};
+    //! @brief Estimated bytes used by the messages retained by the node.
+    struct retain_bytes {};
 
     //! @brief Color of the current node.
     struct node_color {};
@@ -63,6 +100,8 @@ namespace tags {
     struct nbcoop_real {};
     //! @brief mlcoop real algorithm
     struct mlcoop_real {};
+    //! @brief mltrack real algorithm
+    struct mltrack_real {};
     //! @brief wmlcoop real algorithm
     struct wmlcoop_real {};
 
@@ -77,62 +116,114 @@ namespace tags {
     //! @brief message size for an algorithm
     template <typename T>
     struct msg_size {};
+
+    //! @brief multilateration iterations for an algorithm
+    template <typename T>
+    struct iterations {};
 }
 
 
+//! @brief The algorithms run by the main function.
+using algorithm_tags = common::type_sequence<
+    tags::dv_all_real, tags::dv_all_hop, tags::dv_6close_real, tags::dv_6close_hop, tags::nbcoop_real, tags::mlcoop_real, tags::mltrack_real
+>;
+
+//! @brief Index of an algorithm in a sequence of algorithms (the sequence size if absent).
+template <typename A, typename... As>
+constexpr size_t algorithm_index(common::type_sequence<As...>) {
+    size_t i = 0, r = sizeof...(As);
+    ((std::is_same<A, As>::value ? r = i : r, ++i), ...);
+    return r;
+}
+
+//! @brief Names of a sequence of algorithms.
+template <typename... As>
+std::vector<std::string> algorithm_names(common::type_sequence<As...>) {
+    return {common::strip_namespaces(common::type_name<As>())...};
+}
+
+#ifdef FCPP_GUI
+/**
+ * @brief Node colour depending on the distance error of the displayed algorithm.
+ *
+ * Rounds only store the error: the conversion to a colour is performed by the renderer
+ * when it reads the node colour to draw it.
+ */
+struct error_color {
+    //! @brief The distance error (NaN for inactive nodes).
+    real_t error = std::numeric_limits<real_t>::quiet_NaN();
+
+    //! @brief Conversion to a colour (green to red as the error grows, gray for inactive nodes).
+    operator color() const {
+        return std::isnan(error) ? color(DIM_GRAY) : color::hsva(120 - 2*error, 1, 1);
+    }
+};
+
+//! @brief Printing error colours.
+inline std::ostream& operator<<(std::ostream& o, error_color const& c) {
+    return o << c.error;
+}
+#endif
+
+#ifdef LOCALISATION_BENCHMARK
+//! @brief Seconds spent by the current thread running an algorithm (for benchmarking purposes).
+template <typename A>
+inline double& algorithm_time() {
+    thread_local double seconds = 0;
+    return seconds;
+}
+#endif
+
+#ifdef LOCALISATION_LEAN
+//! @brief Whether multilateration iterations are monitored for an algorithm (never in the memory-lean configuration).
+template <typename A>
+constexpr bool monitor_iterations = false;
+#else
+//! @brief Whether multilateration iterations are monitored for an algorithm (not based on multilateration for nbcoop).
+template <typename A>
+constexpr bool monitor_iterations = not std::is_same<A, tags::nbcoop_real>::value;
+#endif
+
 //! @brief Runs an algorithm and saves monitoring data.
 GEN(A, F) void monitor_algorithm(ARGS, A, F&& fun) { CODE
     using namespace tags;
     PROFILE_COUNT("round/main/" + common::strip_namespaces(common::type_name<A>()));
     size_t msiz_pre = node.cur_msg_size();
+    size_t iter_pre = multilateration_iterations();
+#ifdef LOCALISATION_BENCHMARK
+    auto start = std::chrono::steady_clock::now();
     node.storage(pos<A>{}) = std::forward<F>(fun)();
+    algorithm_time<A>() += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#else
+    node.storage(pos<A>{}) = std::forward<F>(fun)();
+#endif
     node.storage(error<A>{}) = distance(node.position(), node.storage(pos<A>{}));
     node.storage(msg_size<A>{}) = node.cur_msg_size() - msiz_pre;
+    if constexpr (monitor_iterations<A>)
+        node.storage(iterations<A>{}) = multilateration_iterations() - iter_pre;
 #ifdef FCPP_GUI
-    if (node.net.storage(tags::display{}) == common::strip_namespaces(common::type_name<A>()))
-        node.storage(node_color{}) = color::hsva(120 - 2*node.storage(error<A>{}), 1, 1);
+    if (node.net.storage(display{}) == algorithm_index<A>(algorithm_tags{}))
+        node.storage(node_color{}).error = node.storage(error<A>{});
 #endif
 }
 //! @brief Storage list for function monitor_algorithm.
 GEN_EXPORT(A) monitor_algorithm_s = storage_list<
     tags::pos<A>,       vec<2>,
-    tags::error<A>,     real_t,
-    tags::msg_size<A>,  size_t
+    tags::error<A>,     error_type,
+    tags::msg_size<A>,  msg_size_type,
+    std::conditional_t<monitor_iterations<A>, storage_list<tags::iterations<A>, uint32_t>, storage_list<>>
 >;
 //! @brief Aggregator list for function monitor_algorithm.
 GEN_EXPORT(A) monitor_algorithm_a = storage_list<
     tags::error<A>,     aggregator::mean<real_t>,
-    tags::msg_size<A>,  aggregator::mean<real_t>
+    tags::msg_size<A>,  aggregator::mean<real_t>,
+    std::conditional_t<monitor_iterations<A>, storage_list<tags::iterations<A>, aggregator::mean<real_t>>, storage_list<>>
 >;
 
 
-// @brief Main function.
-MAIN() {
-    // import tag names in the local scope.
+//! @brief Runs the DV algorithms and saves monitoring data.
+FUN void dv_algorithms(ARGS, vec<2> init, field<real_t> const& nbr_dist) { CODE
     using namespace tags;
-#ifdef FCPP_GUI
-    // node display style
-    node.storage(node_size{})  = node.storage(is_anchor{}) ? 12 : 8;
-    node.storage(node_shape{}) = node.storage(is_anchor{}) ? shape::cube : shape::sphere;
-#endif
-    // 1/4 of the nodes are down between times bad_time and 2*bad_time
-    if (node.uid % 4 == 0 and node.current_time() > bad_time and node.next_time() < 2*bad_time) {
-#ifdef FCPP_GUI
-        node.storage(node_shape{}) = node.storage(is_anchor{}) ? shape::tetrahedron : shape::icosahedron;
-        node.storage(node_color{}) = color(DIM_GRAY);
-#endif
-        return;
-    }
-    // device long-range movement
-    if (not node.storage(is_anchor{}))
-        rectangle_walk(CALL, make_vec(0,0), make_vec(500,500), node.net.storage(speed{}), 1);
-    // distances with error
-    field<real_t> nbr_dist = map_hood([&](real_t d){
-        return d * node.storage(random{})(node.generator());
-    }, node.nbr_dist());
-    // initial random position
-    vec<2> init = make_vec(node.next_real(0,500), node.next_real(0,500));
-
     monitor_algorithm(CALL, dv_all_real{}, [&](){
         return dv_all(CALL, init, node.storage(is_anchor{}), nbr_dist, 80, 1000);
     });
@@ -146,12 +237,22 @@ MAIN() {
     monitor_algorithm(CALL, dv_6close_hop{}, [&](){
         return dv_kclose(CALL, 6, init, node.storage(is_anchor{}), 1, 1);
     });
+}
+//! @brief Export list for dv_algorithms.
+FUN_EXPORT dv_algorithms_t = export_list<dv_all_t, dv_kclose_t>;
+
+//! @brief Runs the cooperative algorithms and saves monitoring data.
+FUN void coop_algorithms(ARGS, vec<2> init, field<real_t> const& nbr_dist) { CODE
+    using namespace tags;
     monitor_algorithm(CALL, nbcoop_real{}, [&](){
         return nb_coop(CALL, init, node.storage(is_anchor{}), nbr_dist);
     });
     monitor_algorithm(CALL, mlcoop_real{}, [&](){
         return ml_coop(CALL, init, node.storage(is_anchor{}), nbr_dist);
     });
+    monitor_algorithm(CALL, mltrack_real{}, [&](){
+        return ml_track(CALL, init, node.storage(is_anchor{}), nbr_dist, track_alpha, track_beta);
+    });
     /*
     monitor_algorithm(CALL, wmlcoop_real{}, [&](){
         real_t aw = 15000 / (node.net.storage(tags::variance{})*node.net.storage(component::tags::half_radius{})*node.net.storage(component::tags::radius{}));
@@ -159,15 +260,65 @@ MAIN() {
     });
     */
 }
+//! @brief Export list for coop_algorithms.
+FUN_EXPORT coop_algorithms_t = export_list<nb_coop_t, ml_coop_t, ml_track_t, wml_coop_t>;
+
+
+// @brief Main function.
+MAIN() {
+    // import tag names in the local scope.
+    using namespace tags;
+    ++node.net.storage(rounds{});
+    real_t side_len = node.net.storage(side{});
+#ifdef FCPP_GUI
+    // back to real time after fast-forwarding
+    if (node.net.storage(fast_forward{}) > 0 and node.current_time() >= node.net.storage(fast_forward{})) {
+        node.net.storage(fast_forward{}) = 0;
+        node.net.realtime_factor(1);
+    }
+    // node display style
+    node.storage(node_size{})  = node.storage(is_anchor{}) ? 12 : 8;
+    node.storage(node_shape{}) = node.storage(is_anchor{}) ? shape::cube : shape::sphere;
+#endif
+    // 1/4 of the nodes are down between times bad_time and 2*bad_time
+    if (node.uid % 4 == 0 and node.current_time() > bad_time and node.next_time() < 2*bad_time) {
+#ifdef FCPP_GUI
+        node.storage(node_shape{}) = node.storage(is_anchor{}) ? shape::tetrahedron : shape::icosahedron;
+        node.storage(node_color{}).error = std::numeric_limits<real_t>::quiet_NaN();
+#endif
+        return;
+    }
+    // device long-range movement
+    if (not node.storage(is_anchor{}))
+        rectangle_walk(CALL, make_vec(0,0), make_vec(side_len,side_len), node.net.storage(speed{}), 1);
+    // distances with error
+    field<real_t> nbr_dist = map_hood([&](real_t d){
+        return d * node.net.storage(random{})(node.generator());
+    }, node.nbr_dist());
+    // initial random position
+    vec<2> init = make_vec(node.next_real(0,side_len), node.next_real(0,side_len));
+
+    // algorithms (instantiated in separate translation units, see run/program.hpp)
+    dv_algorithms(CALL, init, nbr_dist);
+    coop_algorithms(CALL, init, nbr_dist);
+    // memory footprint (retained messages are estimated as neighbours times the size of the own message)
+#ifdef LOCALISATION_DEBUG
+    node.storage(heap_bytes{}) = node.storage(debug{}).capacity();
+#endif
+    node.storage(retain_bytes{}) = count_hood(CALL) * node.cur_msg_size();
+}
 //! @brief Export list for the main function.
-FUN_EXPORT main_t = export_list<dv_all_t, dv_kclose_t, nb_coop_t, ml_coop_t, wml_coop_t>;
+FUN_EXPORT main_t = export_list<dv_algorithms_t, coop_algorithms_t>;
 //! @brief Storage list for the main function.
 FUN_EXPORT main_s = storage_list<
+#ifdef LOCALISATION_DEBUG
     tags::debug,        std::string,
-    tags::random,       std::weibull_distribution<real_t>,
+    tags::heap_bytes,   uint32_t,
+#endif
     tags::is_anchor,    bool,
+    tags::retain_bytes, uint32_t,
 #ifdef FCPP_GUI
-    tags::node_color,   color,
+    tags::node_color,   error_color,
     tags::node_size,    real_t,
     tags::node_shape,   shape,
 #endif
@@ -176,16 +327,22 @@ FUN_EXPORT main_s = storage_list<
     monitor_algorithm_s<tags::dv_6close_real>,
     monitor_algorithm_s<tags::dv_6close_hop>,
     monitor_algorithm_s<tags::nbcoop_real>,
-    monitor_algorithm_s<tags::mlcoop_real>
+    monitor_algorithm_s<tags::mlcoop_real>,
+    monitor_algorithm_s<tags::mltrack_real>
 >;
 //! @brief Aggregator list for the main function.
 FUN_EXPORT main_a = storage_list<
+#ifdef LOCALISATION_DEBUG
+    tags::heap_bytes,   aggregator::combine<aggregator::mean<real_t>, aggregator::sum<real_t>>,
+#endif
+    tags::retain_bytes, aggregator::combine<aggregator::mean<real_t>, aggregator::sum<real_t>>,
     monitor_algorithm_a<tags::dv_all_real>,
     monitor_algorithm_a<tags::dv_all_hop>,
     monitor_algorithm_a<tags::dv_6close_real>,
     monitor_algorithm_a<tags::dv_6close_hop>,
     monitor_algorithm_a<tags::nbcoop_real>,
-    monitor_algorithm_a<tags::mlcoop_real>
+    monitor_algorithm_a<tags::mlcoop_real>,
+    monitor_algorithm_a<tags::mltrack_real>
 >;
 
 } // namespace coordination
@@ -218,6 +375,29 @@ constexpr size_t def_hr = 100 - def_var;
 constexpr size_t def_rad = 150;
 //! @brief The default speed simulation parameter.
 constexpr size_t def_v = 0;
+//! @brief The default number of devices.
+constexpr size_t def_devices = 100;
+//! @brief The default side of the simulation area.
+constexpr size_t def_side = 500;
+//! @brief The number of anchors on the perimeter of the default area.
+constexpr size_t def_anchors = 20;
+
+//! @brief Side of the area hosting a given number of devices, with the default density.
+inline real_t side_for(size_t devices) {
+    return def_side * std::sqrt(real_t(devices) / def_devices);
+}
+
+//! @brief Number of extra anchors needed in an area of given side, to keep the default anchor density.
+inline size_t extra_anchors_for(real_t side) {
+    real_t area = side * side / (def_side * def_side);
+    return area > 1 ? std::round(def_anchors * (area - 1)) : 0;
+}
+
+//! @brief Number of nodes spawned with a given number of devices in an area of given side (devices and all anchors).
+inline size_t nodes_for(size_t devices, real_t side) {
+    return devices + def_anchors + extra_anchors_for(side);
+}
+
 //! @brief Plot of error over time.
 using error_time_plot = general_plot<plot::time, error,    half_radius, filter::equal<100-def_var>, radius, filter::equal<def_rad>, speed, filter::equal<def_v>>;
 //! @brief Plot of message size over time.
@@ -234,8 +414,19 @@ using msize_rad_plot = general_plot<radius, msg_size,   plot::time, filter::abov
 using error_speed_plot = general_plot<speed, error,     plot::time, filter::above<mean_time>, radius, filter::equal<def_rad>,   half_radius, filter::equal<100-def_var>>;
 //! @brief Plot of message size over speed.
 using msize_speed_plot = general_plot<speed, msg_size,  plot::time, filter::above<mean_time>, radius, filter::equal<def_rad>,   half_radius, filter::equal<100-def_var>>;
-//! @brief Plotter class for all batch plots.
+//! @brief Plot of multilateration iterations over speed.
+using iters_speed_plot = general_plot<speed, iterations, plot::time, filter::above<mean_time>, radius, filter::equal<def_rad>,   half_radius, filter::equal<100-def_var>>;
+#ifdef LOCALISATION_LEAN
+//! @brief Plotter class for all batch plots (iterations are not stored in the memory-lean configuration).
 using batch_plot = plot::join<error_time_plot, msize_time_plot, error_var_plot, msize_var_plot, error_rad_plot, msize_rad_plot, error_speed_plot, msize_speed_plot>;
+//! @brief Number of rows of batch plots.
+constexpr size_t batch_rows = 4;
+#else
+//! @brief Plotter class for all batch plots.
+using batch_plot = plot::join<error_time_plot, msize_time_plot, error_var_plot, msize_var_plot, error_rad_plot, msize_rad_plot, error_speed_plot, msize_speed_plot, iters_speed_plot>;
+//! @brief Number of rows of batch plots.
+constexpr size_t batch_rows = 5;
+#endif
 
 //! @brief Plot of error over time.
 using error_plot = general_plot<plot::time, error>;
@@ -260,13 +451,20 @@ using log_s = sequence::periodic_n<1, 0, 1, end_time>;
 using connect_t = connect::radial<80, connect::fixed<100>>;
 
 //! @brief The sequence of anchor generation events (20 devices all generated at time 0).
-using anchor_spawn_s = sequence::multiple_n<20, 0>;
-//! @brief The distribution of initial anchor positions (random in a 500x500 square).
-using anchor_pos_d = sequence::rectangle_n<1, 0, 0, 500, 500, 20>;
-//! @brief The sequence of device generation events (100 devices all generated at time 0).
-using device_spawn_s = sequence::multiple_n<100, 0>;
-//! @brief The distribution of initial device positions (random in a 500x500 square).
-using device_pos_d = distribution::rect_n<1, 0, 0, 500, 500>;
+using anchor_spawn_s = sequence::multiple_n<def_anchors, 0>;
+//! @brief The distribution of initial anchor positions (on the perimeter of a 500x500 square).
+using anchor_pos_d = sequence::rectangle_n<1, 0, 0, def_side, def_side, def_anchors>;
+//! @brief The sequence of extra anchor generation events (a given number of anchors all generated at time 0).
+using extra_anchor_spawn_s = sequence::multiple<distribution::constant_i<size_t, extra_anchors>, distribution::constant_n<times_t, 0>>;
+//! @brief The sequence of device generation events (a given number of devices all generated at time 0).
+using device_spawn_s = sequence::multiple<distribution::constant_i<size_t, devices>, distribution::constant_n<times_t, 0>>;
+//! @brief The distribution of initial device positions (random in a square of given side).
+using device_pos_d = distribution::rect<
+    distribution::constant_n<real_t, 0>,
+    distribution::constant_n<real_t, 0>,
+    distribution::constant_i<real_t, side>,
+    distribution::constant_i<real_t, side>
+>;
 
 //! @brief The general simulation options.
 template <bool batch>
@@ -278,8 +476,12 @@ DECLARE_OPTIONS(list,
     node_store<coordination::main_s>,       // the contents of the node storage
     net_store<                              // the contents of the net storage
 #ifdef FCPP_GUI
-        display,        std::string,
+        display,        size_t,
+        fast_forward,   real_t,
 #endif
+        random,         std::weibull_distribution<real_t>,
+        rounds,         size_t,
+        side,           real_t,
         variance,       real_t,
         speed,          real_t,
         half_radius,    real_t,
@@ -296,19 +498,23 @@ DECLARE_OPTIONS(list,
         std::conditional_t<batch, batch_plot, gui_plot>
     >,
     connector<connect_t>,                   // connection predicate
-    retain<metric::retain<5,1>>,            // messages are kept for 5 seconds before expiring
+    retain<metric::retain<retain_time,1>>,  // messages are kept for retain_time seconds before expiring
     round_schedule<round_s>,                // the sequence generator for round events on nodes
     log_schedule<log_s>,                    // the sequence generator for log events on the network
     spawn_schedule<anchor_spawn_s>,         // the sequence generator of anchor creation events on the network
     init<
-        random,     distribution::constant_i<std::weibull_distribution<real_t>, random>,
         variance,   distribution::constant_i<real_t, variance>,
         is_anchor,  distribution::constant_n<bool, true>,
         x,          anchor_pos_d
     >,
+    spawn_schedule<extra_anchor_spawn_s>,   // the sequence generator of extra anchor creation events on the network
+    init<
+        variance,   distribution::constant_i<real_t, variance>,
+        is_anchor,  distribution::constant_n<bool, true>,
+        x,          device_pos_d
+    >,
     spawn_schedule<device_spawn_s>,         // the sequence generator of device creation events on the network
     init<
-        random,     distribution::constant_i<std::weibull_distribution<real_t>, random>,
         variance,   distribution::constant_i<real_t, variance>,
         is_anchor,  distribution::constant_n<bool, false>,
         x,          device_pos_d
@@ -319,6 +525,10 @@ DECLARE_OPTIONS(list,
     color_tag<node_color>   // the color of a node is read from this tag in the store
 );
 
+//! @brief Bytes of node storage of a component (a compile-time constant, reported once per net rather than logged).
+template <typename C>
+constexpr size_t storage_bytes = sizeof(std::decay_t<decltype(std::declval<typename C::node&>().storage_tuple())>);
+
 } // namespace option
 
 } // namespace fcpp
@@ -1,6 +1,8 @@
 #ifndef MULTILATERATION_H_
 #define MULTILATERATION_H_
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "lib/data/vec.hpp"
@@ -13,19 +15,49 @@ namespace fcpp {
 //! @brief Namespace containing the libraries of coordination routines.
 namespace coordination {
 
+//! @brief Number of Levenberg–Marquardt iterations performed by the current thread (for monitoring purposes).
+inline size_t& multilateration_iterations() {
+    thread_local size_t count = 0;
+    return count;
+}
+
+//! @brief Numerical thresholds of the multilateration solver, tuned to the precision of real_t.
+namespace multilateration_limits {
+    //! @brief Whether real numbers have single precision.
+    constexpr bool single = std::numeric_limits<real_t>::digits < std::numeric_limits<double>::digits;
+    //! @brief Machine epsilon of real numbers.
+    constexpr real_t eps = std::numeric_limits<real_t>::epsilon();
+    //! @brief Minimum distance from an anchor for it to be considered (avoids singularities).
+    constexpr real_t min_dist = single ? 1e-3 : 1e-8;
+    //! @brief Minimum damping parameter (avoids underflow to zero after many accepted steps).
+    constexpr real_t min_lambda = single ? 1e-30 : 0;
+
+    //! @brief Whether the determinant of a 2x2 system with given diagonal is too small to solve it (relative to rounding errors in single precision).
+    inline bool singular(real_t det, real_t h00, real_t h11) {
+        return std::abs(det) < (single ? 64 * eps * h00 * h11 : 1e-12);
+    }
+
+    //! @brief Whether a step from a position is below the tolerance (relative to the position magnitude in single precision).
+    inline bool converged(vec<2> const& dp, vec<2> const& pos) {
+        return norm(dp) < (single ? std::max(real_t(1e-6), 16 * eps * norm(pos)) : 1e-6);
+    }
+}
+
 //! @brief Weighted nonlinear least-squares 2D multilateration with the Levenberg–Marquardt method, given an approximated position and a base weight for anchors.
-vec<2> multilateration(vec<2> pos, std::vector<tuple<vec<2>, real_t>> const& anchors, std::vector<real_t> const& weights, real_t base_weight, real_t& weight) {
+inline vec<2> multilateration(vec<2> pos, std::vector<tuple<vec<2>, real_t>> const& anchors, std::vector<real_t> const& weights, real_t base_weight, real_t& weight) {
     // Handle special cases
     if (anchors.size() == 0) return pos;
     if (anchors.size() == 1) {
         vec<2> diff = pos - get<0>(anchors[0]);
         real_t len = norm(diff);
-        if (len < 1e-8) return pos;
+        if (len < multilateration_limits::min_dist) return pos;
         diff *= get<1>(anchors[0]) / len;
         return get<0>(anchors[0]) + diff;
     }
     real_t lambda = 1e-3; // normal equation parameter
+    size_t& iterations = multilateration_iterations();
     for (int iter = 0; iter < 100; ++iter) {
+        ++iterations;
         // Accumulate JᵀJ and Jᵀr
         real_t H00 = 0, H01 = 0, H11 = 0;
         vec<2> g{0,0};
@@ -33,7 +65,7 @@ vec<2> multilateration(vec<2> pos, std::vector<tuple<vec<2>, real_t>> const& anc
         for (int i=0; i<anchors.size(); ++i) {
             vec<2> delta = pos - get<0>(anchors[i]);
             real_t r = norm(delta);
-            if (r < 1e-8) continue; // avoid singularity
+            if (r < multilateration_limits::min_dist) continue; // avoid singularity
             real_t ri = r - get<1>(anchors[i]);
             vec<2> J = delta / r;
             if (weights.size()) {
@@ -57,7 +89,7 @@ vec<2> multilateration(vec<2> pos, std::vector<tuple<vec<2>, real_t>> const& anc
         H11 += lambda;
         // Solve 2x2 system
         real_t det = H00 * H11 - H01 * H01;
-        if (std::abs(det) < 1e-12)
+        if (multilateration_limits::singular(det, H00, H11))
             break;
         vec<2> dp{-H11 * g[0] + H01 * g[1], H01 * g[0] - H00 * g[1]};
         dp /= det;
@@ -75,8 +107,8 @@ vec<2> multilateration(vec<2> pos, std::vector<tuple<vec<2>, real_t>> const& anc
         if (newCost < cost) {
             if (weights.size()) weight = 1 / std::sqrt(1 / (base_weight*base_weight) + vNew);
             pos = pNew;
-            lambda *= 0.3;
-            if (norm(dp) < 1e-6) break; // tolerance
+            lambda = std::max(real_t(lambda * 0.3), multilateration_limits::min_lambda);
+            if (multilateration_limits::converged(dp, pos)) break; // tolerance
         } else {
             lambda *= 2.0;
         }
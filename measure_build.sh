@@ -0,0 +1,42 @@
+#!/bin/bash
+# Measures clean and incremental build times of the batch and graphic targets.
+# Usage: ./measure_build.sh [<revision>]
+# Measures the current tree without and with the precompiled FCPP headers, and also the given revision (e.g. the
+# commit before the build was split, for a before/after comparison) in its default configuration.
+# Run after the FCPP submodule has been set up by make.sh (e.g. ./make.sh run -O batch).
+# The incremental build follows a change to an algorithm file (lib/coop.hpp).
+
+TIMEFORMAT=%R
+# Prints the seconds taken by a command (discarding its output).
+seconds() {
+    { time "$@" > /dev/null 2>&1; } 2>&1 | tail -n 1
+}
+
+# Measures the targets of a source tree with a given label and CMake options.
+measure() {
+    src=$1
+    label=$2
+    shift 2
+    dir=$PWD/_build_time_$label
+    rm -rf $dir
+    cmake -S $src -B $dir -DCMAKE_BUILD_TYPE=Release -DFCPP_BUILD_GL=ON "$@" > /dev/null || exit 1
+    for target in batch graphic; do
+        clean=$(seconds cmake --build $dir -j --target $target)
+        touch $src/lib/coop.hpp
+        incremental=$(seconds cmake --build $dir -j --target $target)
+        printf "%-16s %-10s %12s %12s\n" $label $target $clean $incremental
+    done
+    rm -rf $dir
+}
+
+printf "%-16s %-10s %12s %12s\n" "build" "target" "clean (s)" "incr. (s)"
+if [ "$1" != "" ]; then
+    tree=$PWD/_build_time_tree
+    rm -rf $tree
+    git worktree add --detach $tree $1 > /dev/null 2>&1 || exit 1
+    rmdir $tree/fcpp && ln -s $PWD/fcpp $tree/fcpp
+    measure $tree $(git rev-parse --short $1)
+    git worktree remove --force $tree
+fi
+measure $PWD pch-off -DLOCALISATION_PCH=OFF
+measure $PWD pch-on -DLOCALISATION_PCH=ON
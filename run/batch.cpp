@@ -5,7 +5,11 @@
  * @brief Runs a batch of executions of the aggregate indoor localisation case study.
  */
 
-#include "lib/localisation.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "run/program.hpp"
 
 using namespace fcpp;
 
@@ -13,10 +17,16 @@ using namespace fcpp;
 int main() {
     using namespace fcpp;
 
+    // Whether real numbers have single precision (batch_float target, built from this file with FCPP_REAL_TYPE=float).
+    constexpr bool single = std::is_same<real_t, float>::value;
+    // The name of the batch and the directory for its output.
+    std::string name = single ? "batch_float" : "batch";
+    std::string dir = single ? "output/float/" : "output/";
+    std::filesystem::create_directories(dir);
     // The plotter object.
     option::batch_plot p;
     // The component type (batch simulator with given options).
-    using comp_t = component::batch_simulator<option::list<true>>;
+    using comp_t = option::comp_t;
     // The list of initialisation values to be used for simulations.
     auto init_list = batch::make_tagged_tuple_sequence(
         batch::arithmetic<option::seed       >(  0,  99,    1),                        // 100 different random seeds
@@ -24,7 +34,7 @@ int main() {
         batch::arithmetic<option::radius     >( 50, 300,   10, (int)option::def_rad),  //  26 different communication radiuses
         batch::arithmetic<option::speed      >(0.0, 5.0, 0.25, (double)option::def_v), //  21 different device speeds
         // generate output file name for the run
-        batch::stringify<option::output>("output/batch", "txt"),
+        batch::stringify<option::output>(dir + "batch", "txt"),
         // computes half radius from variance
         batch::formula<option::variance, real_t>([](auto const& x) {
             return (100 - common::get<option::half_radius>(x)) / 100.0;
@@ -33,11 +43,27 @@ int main() {
         batch::formula<option::random, std::weibull_distribution<real_t>>([](auto const& x) {
             return distribution::make<std::weibull_distribution>(real_t(1.0), (real_t)common::get<option::variance>(x));
         }),
+        batch::constant<option::devices>(option::def_devices), // number of devices
+        batch::constant<option::side>((real_t)option::def_side),  // side of the area
+        batch::constant<option::extra_anchors>(option::extra_anchors_for(option::def_side)), // no extra anchors
         batch::constant<option::plotter>(&p) // reference to the plotter object
     );
-    // Runs the given simulations.
-    batch::run(comp_t{}, init_list);
+    // Runs the given simulations in parallel (as batch::run does), saving the rounds counted by each network.
+    std::vector<size_t> net_rounds(init_list.size());
+    auto start = std::chrono::steady_clock::now();
+    common::parallel_for(common::tags::dynamic_execution{}, init_list.size(), [&](size_t i, size_t) {
+        comp_t::net network{init_list[i]};
+        network.run();
+        net_rounds[i] = network.storage(option::rounds{});
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    size_t rounds = 0;
+    for (size_t r : net_rounds) rounds += r;
+    // Logs the overall throughput and the node storage size (per node and in total for a run, the same for every run).
+    size_t nodes = option::nodes_for(option::def_devices, option::def_side);
+    std::ofstream(dir + "throughput.txt") << "rounds " << rounds << "\nseconds " << elapsed.count() << "\nrounds/sec " << rounds / elapsed.count()
+        << "\nstorage_bytes " << option::storage_bytes<comp_t> << "\nnodes " << nodes << "\ntotal_storage_bytes " << option::storage_bytes<comp_t> * nodes << std::endl;
     // Builds the resulting plots.
-    std::cout << plot::file("batch", p.build(), {{"MAX_CROP", "1.05"}, {"LOG_LIN", "10"}, {"SIGMA", "0.1"}, {"ROWS", "4"}, {"COLS", "2"}});
+    std::cout << plot::file(name, p.build(), {{"MAX_CROP", "1.05"}, {"LOG_LIN", "10"}, {"SIGMA", "0.1"}, {"ROWS", std::to_string(option::batch_rows)}, {"COLS", "2"}});
     return 0;
 }
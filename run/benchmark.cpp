@@ -0,0 +1,244 @@
+// Copyright © 2026 Giorgio Audrito and Leonardo Bertolino. All Rights Reserved.
+
+/**
+ * @file benchmark.cpp
+ * @brief Performance regression benchmarks of the aggregate indoor localisation case study.
+ *
+ * Usage: `benchmark [--quick] [--update] [--machine <description>] [--baseline <file>] [--output <file>]`.
+ * Runs fixed-seed micro-benchmarks of multilateration with varying number of anchors and macro-benchmarks
+ * (headless runs with 100, 1000 and 10000 devices), writes the results as JSON and compares them with a baseline file,
+ * exiting with a non-zero status if a statistically significant regression is found (benchmarks missing from the
+ * baseline are reported but not fatal, until a baseline is committed for them).
+ * With `--quick` the 10000 devices run is skipped, with `--update` the results overwrite the baseline
+ * (recording the description of the reference machine given with `--machine`).
+ *
+ * The `benchmark_algorithms` target is built from this file with `LOCALISATION_BENCHMARK` defined (see CMakeLists.txt),
+ * and only measures the round cost of every algorithm with 100 devices: the timing instrumentation is thus never
+ * included in the macro-benchmarks.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <regex>
+
+#include "run/headless.hpp"
+
+using namespace fcpp;
+
+//! @brief Simulated time for which headless runs are executed.
+constexpr times_t horizon = 20;
+//! @brief Minimum relative slowdown for a change to be considered a regression.
+constexpr double min_slowdown = 0.05;
+//! @brief Minimum relative slowdown for a regression, when there are not enough samples for a statistical test.
+constexpr double min_slowdown_untested = 0.2;
+//! @brief Minimum value of Welch's t statistic for a slowdown to be considered significant.
+constexpr double min_t = 3;
+
+//! @brief Repeated measures of a benchmark (lower values are better).
+struct measure {
+    //! @brief Name of the benchmark.
+    std::string name;
+    //! @brief Unit of the samples.
+    std::string unit;
+    //! @brief Sampled values.
+    std::vector<double> samples;
+    //! @brief Mean of the baseline (NaN if absent).
+    double base_mean = std::numeric_limits<double>::quiet_NaN();
+    //! @brief Standard deviation of the baseline.
+    double base_dev = 0;
+    //! @brief Number of samples of the baseline.
+    size_t base_n = 0;
+
+    //! @brief Mean of the samples.
+    double mean() const {
+        double s = 0;
+        for (double x : samples) s += x;
+        return s / samples.size();
+    }
+
+    //! @brief Sample standard deviation.
+    double dev() const {
+        if (samples.size() < 2) return 0;
+        double m = mean(), s = 0;
+        for (double x : samples) s += (x - m) * (x - m);
+        return std::sqrt(s / (samples.size() - 1));
+    }
+
+    //! @brief Relative change with respect to the baseline.
+    double change() const {
+        return mean() / base_mean - 1;
+    }
+
+    //! @brief Whether the measure is a significant regression with respect to the baseline.
+    bool regression() const {
+        if (not std::isfinite(base_mean) or not (change() > min_slowdown)) return false;
+        if (samples.size() < 2 or base_n < 2) return change() > min_slowdown_untested;
+        double se = std::sqrt(dev() * dev() / samples.size() + base_dev * base_dev / base_n);
+        return se == 0 or (mean() - base_mean) / se > min_t;
+    }
+};
+
+//! @brief Accesses the measure with a given name, creating it if needed.
+measure& get(std::vector<measure>& ms, std::string const& name, std::string const& unit) {
+    for (measure& m : ms) if (m.name == name) return m;
+    ms.push_back(measure{name, unit});
+    return ms.back();
+}
+
+//! @brief Nanoseconds per multilateration with a given number of anchors, averaged on a batch of random problems.
+double solver_sample(size_t anchors, std::mt19937& gen) {
+    constexpr size_t problems = 1000;
+    std::uniform_real_distribution<real_t> coord(0, 500), noise(0.95, 1.05);
+    std::vector<std::vector<tuple<vec<2>, real_t>>> data(problems);
+    std::vector<vec<2>> start(problems);
+    for (size_t i = 0; i < problems; ++i) {
+        vec<2> p = make_vec(coord(gen), coord(gen));
+        start[i] = make_vec(coord(gen), coord(gen));
+        for (size_t j = 0; j < anchors; ++j) {
+            vec<2> q = make_vec(coord(gen), coord(gen));
+            data[i].emplace_back(q, distance(p, q) * noise(gen));
+        }
+    }
+    real_t sink = 0;
+    auto t = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < problems; ++i)
+        sink += coordination::multilateration(start[i], data[i])[0];
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t;
+    volatile real_t keep = sink;
+    (void)keep;
+    return elapsed.count() * 1e9 / problems;
+}
+
+#ifdef LOCALISATION_BENCHMARK
+//! @brief Resets the time spent running algorithms.
+template <typename... As>
+void reset_algorithms(common::type_sequence<As...>) {
+    ((coordination::algorithm_time<As>() = 0), ...);
+}
+
+//! @brief Records the microseconds per round spent running every algorithm.
+template <typename... As>
+void record_algorithms(common::type_sequence<As...>, std::vector<measure>& ms, size_t rounds) {
+    ((get(ms, std::string("algorithm/") + common::strip_namespaces(common::type_name<As>()), "us/round").samples.push_back(coordination::algorithm_time<As>() * 1e6 / rounds)), ...);
+}
+#endif
+
+//! @brief Whether a string can be written in a JSON string as is (and read back by read_baseline).
+bool json_plain(std::string const& s) {
+    for (char c : s) if (c == '"' or c == '\\' or (unsigned char)c < 0x20) return false;
+    return true;
+}
+
+//! @brief Reads the baseline measures from a file (written by write_json), returning the description of its machine.
+std::string read_baseline(std::string const& file, std::vector<measure>& ms) {
+    std::ifstream in(file);
+    std::regex entry(R"rx("name": "([^"]*)".*"mean": ([^,]*), "stddev": ([^,]*), "samples": ([0-9]+))rx");
+    std::regex header(R"rx("machine": "([^"]*)")rx");
+    std::string line, machine;
+    std::smatch m;
+    while (std::getline(in, line)) {
+        if (std::regex_search(line, m, header)) machine = m[1];
+        else if (std::regex_search(line, m, entry)) for (measure& x : ms) if (x.name == m[1]) {
+            x.base_mean = std::stod(m[2]);
+            x.base_dev = std::stod(m[3]);
+            x.base_n = std::stoul(m[4]);
+        }
+    }
+    return machine;
+}
+
+//! @brief Writes the measures as JSON, together with their comparison with the baseline if present.
+void write_json(std::string const& file, std::string const& machine, std::vector<measure> const& ms, bool compare) {
+    std::ofstream out(file);
+    out << "{\n    \"machine\": \"" << machine << "\",\n    \"results\": [\n";
+    for (size_t i = 0; i < ms.size(); ++i) {
+        measure const& m = ms[i];
+        out << "        {\"name\": \"" << m.name << "\", \"unit\": \"" << m.unit << "\", \"mean\": " << m.mean() << ", \"stddev\": " << m.dev() << ", \"samples\": " << m.samples.size();
+        if (compare and std::isfinite(m.base_mean))
+            out << ", \"baseline\": " << m.base_mean << ", \"change\": " << m.change() << ", \"regression\": " << (m.regression() ? "true" : "false");
+        out << "}" << (i+1 < ms.size() ? "," : "") << "\n";
+    }
+    out << "    ]\n}\n";
+}
+
+//! @brief The main function.
+int main(int argc, char *argv[]) {
+    using namespace fcpp;
+
+    // Parse command line arguments.
+    bool quick = false, update = false;
+#ifdef LOCALISATION_BENCHMARK
+    std::string baseline = "bench/baseline_algorithms.json";
+    std::string output = "output/benchmark_algorithms.json";
+#else
+    std::string baseline = "bench/baseline.json";
+    std::string output = "output/benchmark.json";
+#endif
+    std::string machine;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") quick = true;
+        else if (arg == "--update") update = true;
+        else if (arg == "--machine" and i+1 < argc) machine = argv[++i];
+        else if (arg == "--baseline" and i+1 < argc) baseline = argv[++i];
+        else if (arg == "--output" and i+1 < argc) output = argv[++i];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--quick] [--update] [--machine <description>] [--baseline <file>] [--output <file>]" << std::endl;
+            return 2;
+        }
+    }
+    if (update and machine.empty()) {
+        std::cerr << "--update requires a --machine description of the reference machine" << std::endl;
+        return 2;
+    }
+    if (not json_plain(machine)) {
+        std::cerr << "the --machine description cannot contain quotes, backslashes or control characters" << std::endl;
+        return 2;
+    }
+    std::vector<measure> ms;
+#ifdef LOCALISATION_BENCHMARK
+    // Round cost of every algorithm with 100 devices (instrumented build).
+    for (int seed = 0; seed < 10; ++seed) {
+        reset_algorithms(coordination::algorithm_tags{});
+        headless::result r = headless::run(100, option::def_v, seed, horizon);
+        record_algorithms(coordination::algorithm_tags{}, ms, r.rounds);
+    }
+#else
+    // Micro-benchmarks of the solver.
+    std::mt19937 gen(42);
+    for (size_t anchors : {3, 6, 12, 24, 48}) {
+        measure& m = get(ms, "solver/anchors-" + std::to_string(anchors), "ns/call");
+        for (int s = 0; s < 10; ++s) m.samples.push_back(solver_sample(anchors, gen));
+    }
+    // Macro-benchmarks of headless runs.
+    for (auto [devices, seeds] : std::vector<std::pair<size_t, int>>{{100, 10}, {1000, 3}, {10000, 2}}) {
+        if (quick and devices > 1000) continue;
+        for (int seed = 0; seed < seeds; ++seed) {
+            headless::result r = headless::run(devices, option::def_v, seed, horizon);
+            get(ms, "round/devices-" + std::to_string(devices), "us/round").samples.push_back(r.seconds * 1e6 / r.rounds);
+        }
+    }
+#endif
+    // Compare with the baseline and report.
+    std::string base_machine = read_baseline(baseline, ms);
+    if (std::filesystem::path(output).has_parent_path())
+        std::filesystem::create_directories(std::filesystem::path(output).parent_path());
+    write_json(output, machine, ms, true);
+    if (update) write_json(baseline, machine, ms, false);
+    else std::cout << "baseline measured on: " << (base_machine.empty() ? "unknown machine" : base_machine) << std::endl;
+    bool regressed = false, missing = false;
+    for (measure const& m : ms) {
+        std::cout << m.name << "\t" << m.mean() << " ± " << m.dev() << " " << m.unit;
+        if (std::isfinite(m.base_mean)) {
+            std::cout << "\t(" << (m.change() > 0 ? "+" : "") << m.change() * 100 << "%)";
+            if (m.regression()) std::cout << "\tREGRESSION";
+        } else std::cout << "\t(no baseline)";
+        std::cout << std::endl;
+        regressed = regressed or m.regression();
+        missing = missing or not std::isfinite(m.base_mean);
+    }
+    if (missing and not update)
+        std::cerr << "warning: missing baseline entries in " << baseline << " (not compared): generate them with --update --machine <description> on the reference machine" << std::endl;
+    return regressed ? 1 : 0;
+}
@@ -5,34 +5,63 @@
  * @brief Runs a single execution of the aggregate indoor localisation case study with a graphical user interface.
  */
 
-#include "lib/localisation.hpp"
+#include "run/program.hpp"
 
 using namespace fcpp;
 
+//! @brief Parses a finite non-negative number from a command line argument (NaN if invalid).
+real_t parse_arg(char const* arg) {
+    char* end;
+    real_t x = std::strtod(arg, &end);
+    if (end == arg or *end != '\0' or not std::isfinite(x) or x < 0)
+        return std::numeric_limits<real_t>::quiet_NaN();
+    return x;
+}
+
 //! @brief The main function.
 int main(int argc, char *argv[]) {
     using namespace fcpp;
 
+    // Calculate simulation parameters.
+    real_t comm_radius = option::def_rad;
+    real_t variance = option::def_var;
+    real_t speed = option::def_v;
+    std::string algo = "mlcoop_real";
+    real_t fast_forward = 0;
+    real_t frame_rate = 60;
+    real_t devices = option::def_devices;
+    real_t side = -1;
+    if (argc >= 5) {
+        comm_radius = parse_arg(argv[1]);
+        variance = parse_arg(argv[2]);
+        speed = parse_arg(argv[3]);
+        algo = argv[4];
+    }
+    if (argc >= 6) fast_forward = parse_arg(argv[5]);
+    if (argc >= 7) frame_rate = parse_arg(argv[6]);
+    if (argc >= 8) devices = parse_arg(argv[7]);
+    if (argc >= 9) side = parse_arg(argv[8]);
+    if (side < 0) side = option::side_for(devices);
+    std::vector<std::string> names = coordination::algorithm_names(coordination::algorithm_tags{});
+    size_t display = std::find(names.begin(), names.end(), algo) - names.begin();
+    if (argc > 9 or (argc > 1 and argc < 5) or std::isnan(comm_radius + variance + speed + fast_forward + frame_rate + devices + side) or variance > 100 or frame_rate == 0 or side == 0 or display == names.size()) {
+        std::cerr << "usage: " << argv[0] << " [<comm_radius> <variance> <speed> <algorithm> [<fast_forward> [<frame_rate> [<devices> [<side>]]]]]" << std::endl;
+        std::cerr << "with non-negative numbers (variance at most 100, frame_rate and side positive) and algorithm among:";
+        for (std::string const& n : names) std::cerr << " " << n;
+        std::cerr << std::endl;
+        return 1;
+    }
     // The plotter object.
     option::gui_plot p;
     std::cout << "/*\n";
     {
-        // Calculate simulation parameters.
-        real_t comm_radius = option::def_rad;
-        real_t variance = option::def_var;
-        real_t speed = option::def_v;
-        std::string algo = "mlcoop_real";
-        if (argc == 5) {
-            comm_radius = std::atof(argv[1]);
-            variance = std::atof(argv[2]);
-            speed = std::atof(argv[3]);
-            algo = argv[4];
-        }
         real_t half_radius = 100 - variance;
         variance /= 100;
         std::weibull_distribution<real_t> distr = distribution::make<std::weibull_distribution>(real_t(1.0), variance);
-        // The network object type (interactive simulator with given options).
-        using net_t = component::interactive_simulator<option::list<false>>::net;
+        // The component type (interactive simulator with given options).
+        using comp_t = option::comp_t;
+        // The network object type.
+        using net_t = comp_t::net;
         // The initialisation values (simulation name).
         auto init_v = common::make_tagged_tuple_t(
             option::name{},         "Cooperative Indoor Localisation",
@@ -42,10 +71,19 @@ int main(int argc, char *argv[]) {
             option::variance{},     variance,
             option::random{},       distr,
             option::speed{},        speed,
-            option::display{},      algo
+            option::devices{},      (size_t)devices,
+            option::side{},         side,
+            option::extra_anchors{},option::extra_anchors_for(side),
+            option::display{},      display,
+            option::fast_forward{}, fast_forward,
+            option::refresh_rate{}, 1 / frame_rate,
+            // runs as fast as possible until the fast-forward time
+            option::realtime_factor{}, fast_forward > 0 ? std::numeric_limits<real_t>::infinity() : real_t(1)
         );
         // Construct the network object.
         net_t network{init_v};
+        size_t nodes = option::nodes_for(devices, side);
+        std::cout << "node storage: " << option::storage_bytes<comp_t> << " bytes per node, " << option::storage_bytes<comp_t> * nodes << " bytes for " << nodes << " nodes\n";
         // Run the simulation until exit.
         network.run();
     }
@@ -0,0 +1,72 @@
+// Copyright © 2026 Giorgio Audrito and Leonardo Bertolino. All Rights Reserved.
+
+/**
+ * @file headless.hpp
+ * @brief Headless executions of the aggregate indoor localisation case study, for benchmarking.
+ */
+
+#ifndef HEADLESS_H_
+#define HEADLESS_H_
+
+#include <chrono>
+
+#include "run/program.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for headless executions of the case study.
+namespace headless {
+
+//! @brief Outcome of a headless execution.
+struct result {
+    //! @brief Number of rounds performed.
+    size_t rounds;
+    //! @brief Wall-clock seconds elapsed.
+    double seconds;
+    //! @brief Bytes of node storage.
+    size_t storage_bytes;
+};
+
+//! @brief Runs a simulation with default parameters and a given number of devices at default density and speed, until a given simulated time.
+inline result run(size_t devices, real_t speed, int seed, times_t horizon) {
+    // The side of the area and the anchors keeping the default densities.
+    real_t side = option::side_for(devices);
+    // The plotter object (not used for output).
+    option::batch_plot p;
+    // A stream discarding simulation logs.
+    std::ostream null_stream(nullptr);
+    // The component type (batch simulator with given options).
+    using comp_t = option::comp_t;
+    // The network object type.
+    using net_t = comp_t::net;
+    // The initialisation values.
+    auto init_v = common::make_tagged_tuple_t(
+        option::seed{},         seed,
+        option::output{},       &null_stream,
+        option::plotter{},      &p,
+        option::radius{},       (real_t)option::def_rad,
+        option::half_radius{},  (real_t)option::def_hr,
+        option::variance{},     (real_t)option::def_var / 100,
+        option::random{},       distribution::make<std::weibull_distribution>(real_t(1.0), (real_t)option::def_var / 100),
+        option::speed{},        speed,
+        option::devices{},      devices,
+        option::extra_anchors{},option::extra_anchors_for(side),
+        option::side{},         side
+    );
+    // Construct the network object.
+    net_t network{init_v};
+    // Run the simulation up to the horizon.
+    auto start = std::chrono::steady_clock::now();
+    while (network.next() < horizon) network.update();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {network.storage(option::rounds{}), elapsed.count(), option::storage_bytes<comp_t>};
+}
+
+} // namespace headless
+
+} // namespace fcpp
+
+#endif // HEADLESS_H_
@@ -0,0 +1,53 @@
+// Copyright © 2026 Giorgio Audrito and Leonardo Bertolino. All Rights Reserved.
+
+/**
+ * @file program.hpp
+ * @brief The aggregate indoor localisation program, with its algorithms instantiated in separate translation units.
+ *
+ * Including this header declares the instantiations of `dv_algorithms` and `coop_algorithms` as extern, so that the
+ * algorithms are not instantiated in the including translation unit together with the main program, the plots and
+ * the simulation options. They are instead defined in `program_dv.cpp` and `program_coop.cpp`, which every target
+ * compiles in parallel with its main translation unit. Every target is built in this way, so that benchmarks measure
+ * the same code as the other executables: the algorithms of a family are inlined in its round function, which is called
+ * once per round by the main program.
+ */
+
+#ifndef PROGRAM_H_
+#define PROGRAM_H_
+
+#include "lib/localisation.hpp"
+
+//! @brief Instantiation of the DV algorithms (with prefix `template` for definitions, `extern template` for declarations).
+#define LOCALISATION_DV_INSTANCE(prefix) \
+    prefix void coordination::dv_algorithms<option::node_t>(option::node_t&, trace_t, vec<2>, field<real_t> const&);
+
+//! @brief Instantiation of the cooperative algorithms (with prefix `template` for definitions, `extern template` for declarations).
+#define LOCALISATION_COOP_INSTANCE(prefix) \
+    prefix void coordination::coop_algorithms<option::node_t>(option::node_t&, trace_t, vec<2>, field<real_t> const&);
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for component options.
+namespace option {
+
+#ifdef LOCALISATION_INTERACTIVE
+//! @brief The component type of graphical simulations (graphic target, see CMakeLists.txt).
+using comp_t = component::interactive_simulator<list<false>>;
+#else
+//! @brief The component type of batch and headless simulations.
+using comp_t = component::batch_simulator<list<true>>;
+#endif
+//! @brief The node type of the simulations.
+using node_t = comp_t::node;
+
+} // namespace option
+
+LOCALISATION_DV_INSTANCE(extern template)
+LOCALISATION_COOP_INSTANCE(extern template)
+
+} // namespace fcpp
+
+#endif // PROGRAM_H_
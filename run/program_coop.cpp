@@ -0,0 +1,14 @@
+// Copyright © 2026 Giorgio Audrito and Leonardo Bertolino. All Rights Reserved.
+
+/**
+ * @file program_coop.cpp
+ * @brief Explicit instantiation of the cooperative algorithms for the simulation node type.
+ */
+
+#include "run/program.hpp"
+
+namespace fcpp {
+
+LOCALISATION_COOP_INSTANCE(template)
+
+} // namespace fcpp
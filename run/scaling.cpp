@@ -0,0 +1,30 @@
+// Copyright © 2026 Giorgio Audrito and Leonardo Bertolino. All Rights Reserved.
+
+/**
+ * @file scaling.cpp
+ * @brief Measures the time per round of headless executions of the case study, with increasing number of devices at constant device and anchor density, for static and moving devices.
+ */
+
+#include "run/headless.hpp"
+
+using namespace fcpp;
+
+//! @brief Simulated time for which every configuration is run.
+constexpr times_t horizon = 20;
+//! @brief Device speeds for which every configuration is run (static and top speed of the batch sweep).
+constexpr real_t speeds[] = {option::def_v, 5};
+
+//! @brief The main function.
+int main() {
+    using namespace fcpp;
+
+    std::cout << "speed\tdevices\tanchors\tside\trounds\tseconds\tms/simulated second\tus/node round\tstorage bytes\n";
+    for (real_t speed : speeds) for (size_t k : {1, 2, 5, 10, 20, 50, 100}) {
+        size_t devices = option::def_devices * k;
+        headless::result r = headless::run(devices, speed, 0, horizon);
+        real_t side = option::side_for(devices);
+        size_t anchors = option::nodes_for(devices, side) - devices;
+        std::cout << speed << "\t" << devices << "\t" << anchors << "\t" << side << "\t" << r.rounds << "\t" << r.seconds << "\t" << r.seconds * 1e3 / horizon << "\t" << r.seconds * 1e6 / r.rounds << "\t" << r.storage_bytes * (devices + anchors) << std::endl;
+    }
+    return 0;
+}